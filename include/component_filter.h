@@ -0,0 +1,341 @@
+#ifndef __COMPONENT_FILTER__
+#define __COMPONENT_FILTER__
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cube.h"
+#include "cube_view.h"
+
+/**
+    Класс описывает фильтр связанных областей куба по размеру.
+
+    Удаляет из куба (обнуляет ячейки) связанные области, состоящие из меньшего
+    количества ячеек, чем заданное, и, при необходимости, оставляет только
+    заданное количество наибольших областей. Фильтр может быть применен к
+    представлению куба: тогда области ищутся только среди ячеек
+    представления, а остальные ячейки куба (в том числе исключенные маской)
+    не изменяются.
+
+    Области находятся системой непересекающихся множеств на массиве предков.
+    Слои представления вдоль оси Z делятся на группы, которые обрабатываются
+    параллельно, после чего объединяются множества на границах групп. Затем
+    за один линейный проход каждой ячейке присваивается номер ее множества и
+    подсчитываются размеры множеств, и вторым проходом (также параллельно по
+    слоям) перезаписываются ячейки куба. Множества ячеек отдельных областей
+    не строятся, массив предков освобождается по завершении фильтрации.
+*/
+class ComponentFilter {
+public:
+
+    ComponentFilter() = delete;                                       //!< Конструктор по умолчанию.
+    ~ComponentFilter() = default;                                     //!< Деструктор.
+    ComponentFilter(ComponentFilter &&) = default;                    //!< Конструктор перемещения.
+    ComponentFilter(const ComponentFilter &) = default;               //!< Конструктор копирования.
+    ComponentFilter & operator = (ComponentFilter &&) = default;      //!< Оператор перемещения.
+    ComponentFilter & operator = (const ComponentFilter &) = default; //!< Оператор присваивания.
+
+    /**
+        Конструктор фильтра.
+
+        @param min_size  Минимальное количество ячеек сохраняемой области
+                         типа std::uint64_t.
+        @param max_count Максимальное количество сохраняемых (наибольших)
+                         областей типа std::uint64_t. По умолчанию не ограничено.
+        @param threads   Количество потоков типа unsigned. По умолчанию равно
+                         std::thread::hardware_concurrency().
+    */
+    ComponentFilter(std::uint64_t min_size, std::uint64_t max_count,
+                    unsigned threads);
+
+    /**
+        Применяет фильтр к кубу, изменяя значения его ячеек.
+
+        @param cube Куб типа Cube.
+    */
+    void apply(Cube & cube);
+
+    /**
+        Применяет фильтр к области куба, изменяя значения ее ячеек.
+
+        В случае, если представление построено не над данным кубом,
+        выбрасывает исключение.
+
+        @param cube Куб типа Cube.
+        @param view Представление области куба типа CubeView.
+        @throw std::runtime_error
+    */
+    void apply(Cube & cube, const CubeView & view);
+
+    /**
+        Применяет фильтр к копии куба.
+
+        @param cube Куб типа Cube.
+        @return Отфильтрованный куб типа Cube.
+    */
+    Cube apply_copy(const Cube & cube);
+
+private:
+
+    std::uint64_t min_size;  /*!< Минимальный размер сохраняемой области */
+    std::uint64_t max_count; /*!< Максимальное количество сохраняемых областей */
+    unsigned threads;        /*!< Количество потоков */
+
+    /**
+        Значение предка для ячеек со значением 0.
+    */
+    static const std::uint64_t none = std::numeric_limits<std::uint64_t>::max();
+
+    /**
+        Возвращает лидера множества, сокращая путь вдвое.
+
+        @param parent Предки ячеек типа std::vector<std::uint64_t>.
+        @param a      Индекс ячейки типа std::uint64_t.
+        @return Индекс лидера типа std::uint64_t.
+    */
+    static std::uint64_t find_set(std::vector<std::uint64_t> & parent,
+                                  std::uint64_t a);
+
+    /**
+        Объединяет два множества, лидером становится меньший индекс.
+
+        @param parent Предки ячеек типа std::vector<std::uint64_t>.
+        @param a      Индекс ячейки типа std::uint64_t.
+        @param b      Индекс ячейки типа std::uint64_t.
+    */
+    static void union_sets(std::vector<std::uint64_t> & parent,
+                           std::uint64_t a, std::uint64_t b);
+
+    /**
+        Создает и объединяет множества индексов в слоях [k_begin, k_end)
+        представления.
+
+        Связи с ячейками слоя k_begin - 1 не рассматриваются.
+
+        @param parent  Предки ячеек типа std::vector<std::uint64_t>.
+        @param view    Представление типа CubeView.
+        @param k_begin Первый слой типа std::uint64_t.
+        @param k_end   Слой, следующий за последним, типа std::uint64_t.
+    */
+    static void make_union_slices(std::vector<std::uint64_t> & parent,
+                                  const CubeView & view,
+                                  std::uint64_t k_begin, std::uint64_t k_end);
+
+    /**
+        Заменяет предка каждой ячейки номером ее множества и возвращает
+        размеры множеств, обнуляя размеры множеств сверх max_count наибольших.
+
+        @param parent Предки ячеек типа std::vector<std::uint64_t>.
+        @return Размеры множеств по номеру в виде std::vector<std::uint64_t>.
+    */
+    std::vector<std::uint64_t> count_sets(std::vector<std::uint64_t> & parent);
+
+    /**
+        Обнуляет ячейки отброшенных множеств в слоях [k_begin, k_end)
+        представления.
+
+        @param cube    Куб типа Cube.
+        @param view    Представление типа CubeView.
+        @param parent  Номера множеств ячеек типа std::vector<std::uint64_t>.
+        @param sizes   Размеры множеств типа std::vector<std::uint64_t>.
+        @param k_begin Первый слой типа std::uint64_t.
+        @param k_end   Слой, следующий за последним, типа std::uint64_t.
+    */
+    void rewrite_slices(Cube & cube, const CubeView & view,
+                        const std::vector<std::uint64_t> & parent,
+                        const std::vector<std::uint64_t> & sizes,
+                        std::uint64_t k_begin, std::uint64_t k_end);
+
+    /**
+        Разбивает слои на группы и вызывает для каждой группы
+        функцию f(k_begin, k_end) в отдельном потоке.
+
+        @param nz Количество слоев типа std::uint64_t.
+        @param f  Функция, принимающая границы группы слоев.
+        @return Начальные слои групп в виде std::vector<std::uint64_t>.
+    */
+    template <class F>
+    std::vector<std::uint64_t> for_each_chunk(std::uint64_t nz, F f);
+};
+
+const std::uint64_t ComponentFilter::none;
+
+ComponentFilter::ComponentFilter(
+    std::uint64_t min_size,
+    std::uint64_t max_count = std::numeric_limits<std::uint64_t>::max(),
+    unsigned threads = std::thread::hardware_concurrency()
+) : min_size{min_size}, max_count{max_count},
+    threads{std::max(threads, 1u)} {}
+
+void ComponentFilter::apply(Cube & cube) {
+    apply(cube, CubeView{cube});
+}
+
+void ComponentFilter::apply(Cube & cube, const CubeView & view) {
+    if (&view.get_cube() != &cube)
+        throw std::runtime_error{"illegal view cube"};
+
+    const std::uint64_t nx = view.get_nx();
+    const std::uint64_t ny = view.get_ny();
+    const std::uint64_t nz = view.get_nz();
+    if (nx == 0 || ny == 0 || nz == 0)
+        return;
+
+    // Предок ячейки по индексу в представлении. Лидером множества всегда
+    // является ячейка с наименьшим индексом, поэтому parent[idx] <= idx
+    std::vector<std::uint64_t> parent(nx * ny * nz);
+
+    std::vector<std::uint64_t> starts = for_each_chunk(nz,
+        [&](std::uint64_t k_begin, std::uint64_t k_end) {
+            make_union_slices(parent, view, k_begin, k_end);
+        });
+
+    // Объединение множеств на границах групп слоев
+    for (std::size_t c = 1; c < starts.size(); ++c)
+        for (std::uint64_t idx = starts[c] * nx * ny;
+             idx < (starts[c] + 1) * nx * ny; ++idx) {
+            std::uint64_t idx_backward = idx - nx * ny;
+            if (parent[idx] != none && parent[idx_backward] != none)
+                union_sets(parent, idx, idx_backward);
+        }
+
+    const std::vector<std::uint64_t> sizes = count_sets(parent);
+
+    for_each_chunk(nz, [&](std::uint64_t k_begin, std::uint64_t k_end) {
+        rewrite_slices(cube, view, parent, sizes, k_begin, k_end);
+    });
+}
+
+Cube ComponentFilter::apply_copy(const Cube & cube) {
+    Cube filtered{cube};
+    apply(filtered);
+    return filtered;
+}
+
+std::uint64_t ComponentFilter::find_set(
+    std::vector<std::uint64_t> & parent, std::uint64_t a) {
+    while (parent[a] != a) {
+        parent[a] = parent[parent[a]];
+        a = parent[a];
+    }
+    return a;
+}
+
+void ComponentFilter::union_sets(
+    std::vector<std::uint64_t> & parent, std::uint64_t a, std::uint64_t b) {
+    a = find_set(parent, a);
+    b = find_set(parent, b);
+    if (a < b)
+        parent[b] = a;
+    else if (b < a)
+        parent[a] = b;
+}
+
+void ComponentFilter::make_union_slices(
+    std::vector<std::uint64_t> & parent, const CubeView & view,
+    std::uint64_t k_begin, std::uint64_t k_end) {
+    const std::uint64_t nx = view.get_nx();
+    const std::uint64_t ny = view.get_ny();
+
+    for (std::uint64_t k = k_begin; k < k_end; ++k)
+        for (std::uint64_t j = 0; j < ny; ++j)
+            for (std::uint64_t i = 0; i < nx; ++i) {
+                std::uint64_t idx = i + j * nx + k * nx * ny;
+                if (!view.get(i, j, k)) {
+                    parent[idx] = none;
+                    continue;
+                }
+                parent[idx] = idx;
+
+                if (i > 0 && parent[idx - 1] != none)
+                    union_sets(parent, idx, idx - 1);
+
+                if (j > 0 && parent[idx - nx] != none)
+                    union_sets(parent, idx, idx - nx);
+
+                if (k > k_begin && parent[idx - nx * ny] != none)
+                    union_sets(parent, idx, idx - nx * ny);
+            }
+}
+
+std::vector<std::uint64_t> ComponentFilter::count_sets(
+    std::vector<std::uint64_t> & parent) {
+    std::vector<std::uint64_t> sizes{};
+
+    // Так как parent[idx] <= idx, при обходе по возрастанию индексов предок
+    // ячейки уже содержит номер множества. Номера назначаются лидерам
+    // в порядке возрастания их индексов
+    for (std::uint64_t idx = 0; idx < parent.size(); ++idx) {
+        if (parent[idx] == none)
+            continue;
+        if (parent[idx] == idx) {
+            parent[idx] = sizes.size();
+            sizes.push_back(0);
+        } else {
+            parent[idx] = parent[parent[idx]];
+        }
+        ++sizes[parent[idx]];
+    }
+
+    if (sizes.size() <= max_count)
+        return sizes;
+
+    // Наибольшие по размеру множества, при равенстве - с меньшим лидером
+    std::vector<std::uint64_t> numbers(sizes.size());
+    for (std::uint64_t n = 0; n < numbers.size(); ++n)
+        numbers[n] = n;
+    auto greater = [&sizes](std::uint64_t a, std::uint64_t b) {
+        return sizes[a] > sizes[b] || (sizes[a] == sizes[b] && a < b);
+    };
+    std::nth_element(numbers.begin(), numbers.begin() + max_count,
+                     numbers.end(), greater);
+    for (auto it = numbers.begin() + max_count; it != numbers.end(); ++it)
+        sizes[*it] = 0;
+
+    return sizes;
+}
+
+void ComponentFilter::rewrite_slices(
+    Cube & cube, const CubeView & view,
+    const std::vector<std::uint64_t> & parent,
+    const std::vector<std::uint64_t> & sizes,
+    std::uint64_t k_begin, std::uint64_t k_end) {
+    const std::uint64_t nx = view.get_nx();
+    const std::uint64_t ny = view.get_ny();
+    const std::uint64_t threshold = std::max(min_size, std::uint64_t(1));
+
+    for (std::uint64_t k = k_begin; k < k_end; ++k)
+        for (std::uint64_t j = 0; j < ny; ++j)
+            for (std::uint64_t i = 0; i < nx; ++i) {
+                std::uint64_t idx = i + j * nx + k * nx * ny;
+                if (parent[idx] != none && sizes[parent[idx]] < threshold)
+                    cube.set(view.get_idx(i, j, k, CellNumbering::global),
+                             false);
+            }
+}
+
+template <class F>
+std::vector<std::uint64_t> ComponentFilter::for_each_chunk(
+    std::uint64_t nz, F f) {
+    const std::uint64_t chunks = std::max(
+        std::min(std::uint64_t(threads), nz), std::uint64_t(1));
+
+    std::vector<std::uint64_t> starts{};
+    for (std::uint64_t c = 0; c <= chunks; ++c)
+        starts.push_back(c * nz / chunks);
+
+    std::vector<std::thread> workers{};
+    for (std::uint64_t c = 1; c < chunks; ++c)
+        workers.emplace_back(f, starts[c], starts[c + 1]);
+    f(starts[0], starts[1]);
+    for (auto & worker : workers)
+        worker.join();
+
+    starts.pop_back();
+    return starts;
+}
+
+#endif // __COMPONENT_FILTER__
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "cube.h"
+#include "cube_view.h"
 
 class ConnectedCells {
 public:
@@ -15,7 +16,8 @@ public:
     ConnectedCells & operator = (ConnectedCells &&) = default;      //!< Оператор перемещения.
     ConnectedCells & operator = (const ConnectedCells &) = default; //!< Оператор присваивания.
 
-    ConnectedCells(const Cube & cube);
+    ConnectedCells(
+        const CubeView & view, CellNumbering numbering = CellNumbering::local);
 
     const std::vector<std::uint64_t> & get_set(std::uint64_t idx) const;
 
@@ -25,16 +27,17 @@ private:
     std::vector<std::vector<std::uint64_t>> sets;
 
     std::vector<std::int8_t> used;
-    Cube cube;
 
-    void dfs(std::uint64_t i, std::uint64_t j, std::uint64_t k);
+    void dfs(const CubeView & view, CellNumbering numbering,
+             std::uint64_t i, std::uint64_t j, std::uint64_t k);
 };
 
-ConnectedCells::ConnectedCells(const Cube & cube)
-    : sets{}, cube{cube} {
-    const std::uint64_t nx = this->cube.get_nx();
-    const std::uint64_t ny = this->cube.get_ny();
-    const std::uint64_t nz = this->cube.get_nz();
+ConnectedCells::ConnectedCells(
+    const CubeView & view, CellNumbering numbering)
+    : sets{} {
+    const std::uint64_t nx = view.get_nx();
+    const std::uint64_t ny = view.get_ny();
+    const std::uint64_t nz = view.get_nz();
     used = std::vector<std::int8_t>(nx * ny * nz, false);
 
     for (std::uint64_t k = 0; k < nz; ++k)
@@ -42,12 +45,12 @@ ConnectedCells::ConnectedCells(const Cube & cube)
             for (std::uint64_t i = 0; i < nx; ++i) {
                 std::uint64_t idx = i + j * nx + k * nx * ny;
                 if (!used[idx]) {
-                    if (this->cube.get(idx) == 0) {
+                    if (view.get(i, j, k) == 0) {
                         used[idx] = true;
                         continue;
                     }
                     sets.push_back(std::vector<std::uint64_t>{});
-                    dfs(i, j, k);
+                    dfs(view, numbering, i, j, k);
                 }
             }
 
@@ -63,22 +66,23 @@ const std::vector<std::uint64_t> & ConnectedCells::get_set(
 
 std::uint64_t ConnectedCells::size() { return sets.size(); }
 
-void ConnectedCells::dfs(std::uint64_t i, std::uint64_t j, std::uint64_t k) {
-    const std::uint64_t nx = cube.get_nx();
-    const std::uint64_t ny = cube.get_ny();
+void ConnectedCells::dfs(const CubeView & view, CellNumbering numbering,
+                         std::uint64_t i, std::uint64_t j, std::uint64_t k) {
+    const std::uint64_t nx = view.get_nx();
+    const std::uint64_t ny = view.get_ny();
     const std::uint64_t idx = i + j * nx + k * nx * ny;
     used[idx] = true;
 
-    if (cube.get(idx) == 0)
+    if (view.get(i, j, k) == 0)
         return;
-    sets[sets.size() - 1].push_back(idx);
-
-    if (k < cube.get_nz() - 1 && !used[idx + nx * ny]) dfs(  i,   j, k+1);
-    if (j < ny - 1            && !used[idx + nx])      dfs(  i, j+1,   k);
-    if (i < nx - 1            && !used[idx + 1])       dfs(i+1,   j,   k);
-    if (k > 0                 && !used[idx - nx * ny]) dfs(  i,   j, k-1);
-    if (j > 0                 && !used[idx - nx])      dfs(  i, j-1,   k);
-    if (i > 0                 && !used[idx - 1])       dfs(i-1,   j,   k);
+    sets[sets.size() - 1].push_back(view.get_idx(i, j, k, numbering));
+
+    if (k < view.get_nz() - 1 && !used[idx + nx * ny]) dfs(view, numbering,   i,   j, k+1);
+    if (j < ny - 1            && !used[idx + nx])      dfs(view, numbering,   i, j+1,   k);
+    if (i < nx - 1            && !used[idx + 1])       dfs(view, numbering, i+1,   j,   k);
+    if (k > 0                 && !used[idx - nx * ny]) dfs(view, numbering,   i,   j, k-1);
+    if (j > 0                 && !used[idx - nx])      dfs(view, numbering,   i, j-1,   k);
+    if (i > 0                 && !used[idx - 1])       dfs(view, numbering, i-1,   j,   k);
 }
 
 #endif // __CONNECTED_CELLS__
\ No newline at end of file
@@ -81,6 +81,30 @@ public:
     */
     bool get(std::uint64_t idx) const;
 
+    /**
+        Задает значение ячейки в кубе по координатам.
+
+        В случае невозможной координаты выбрасывает искючение.
+
+        @param i     Координата вдоль оси X типа std::uint64_t.
+        @param j     Координата вдоль оси Y типа std::uint64_t.
+        @param k     Координата вдоль оси Z типа std::uint64_t.
+        @param value Значение ячейки типа bool.
+        @throw std::runtime_error
+    */
+    void set(std::uint64_t i, std::uint64_t j, std::uint64_t k, bool value);
+
+    /**
+        Задает значение ячейки в кубе по индексу.
+
+        В случае невозможного индекса выбрасывает искючение.
+
+        @param idx   Индекс ячейки в кубе типа std::uint64_t.
+        @param value Значение ячейки типа bool.
+        @throw std::runtime_error
+    */
+    void set(std::uint64_t idx, bool value);
+
     /**
         Возвращает количества ячеек в кубе вдоль оси X.
 
@@ -169,6 +193,20 @@ bool Cube::get(std::uint64_t idx) const {
     return bool(data[idx]);
 }
 
+void Cube::set(std::uint64_t i, std::uint64_t j, std::uint64_t k, bool value) {
+    if (i >= nx) throw std::runtime_error{"illegal nx index"};
+    if (j >= ny) throw std::runtime_error{"illegal ny index"};
+    if (k >= nz) throw std::runtime_error{"illegal nz index"};
+    std::uint64_t idx = i + j * nx + k * nx * ny;
+    data[idx] = std::uint8_t(value);
+}
+
+void Cube::set(std::uint64_t idx, bool value) {
+    if (idx >= data.capacity())
+        throw std::runtime_error{"illegal size index"};
+    data[idx] = std::uint8_t(value);
+}
+
 std::uint64_t Cube::get_nx() const {
     return nx;
 }
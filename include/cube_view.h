@@ -0,0 +1,381 @@
+#ifndef __CUBE_VIEW__
+#define __CUBE_VIEW__
+
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+#include "cube.h"
+
+/**
+    Способ нумерации ячеек в результатах поиска связанных ячеек.
+
+    local  - нумерация внутри представления (CubeView#get_idx()),
+    global - нумерация исходного куба (Cube#get_idx()).
+*/
+enum class CellNumbering { local, global };
+
+/**
+    Класс описывает невладеющее представление области куба.
+
+    Представление задается смещением, количеством ячеек и шагом вдоль
+    каждой из осей X, Y, Z исходного куба. Дополнительно может быть задана
+    маска - куб той же размерности, ячейки которого со значением 0
+    исключают соответствующие ячейки исходного куба.
+    Ячейки представления нумеруются в порядке X -> Y -> Z.
+
+    Представление не копирует данные, поэтому исходный куб (и маска)
+    должны существовать все время использования представления.
+*/
+class CubeView {
+public:
+
+    CubeView() = delete;                                //!< Конструктор по умолчанию.
+    ~CubeView() = default;                              //!< Деструктор.
+    CubeView(CubeView &&) = default;                    //!< Конструктор перемещения.
+    CubeView(const CubeView &) = default;               //!< Конструктор копирования.
+    CubeView & operator = (CubeView &&) = default;      //!< Оператор перемещения.
+    CubeView & operator = (const CubeView &) = default; //!< Оператор присваивания.
+
+    /**
+        Конструктор, создающий представление всего куба.
+
+        @param cube Куб типа Cube.
+    */
+    CubeView(const Cube & cube);
+
+    /**
+        Конструктор, создающий представление всего куба с маской.
+
+        В случае несовпадения размерностей куба и маски выбрасывает исключение.
+
+        @param cube Куб типа Cube.
+        @param mask Маска типа Cube.
+        @throw std::runtime_error
+    */
+    CubeView(const Cube & cube, const Cube & mask);
+
+    /**
+        Конструктор, создающий представление области куба.
+
+        В случае выхода области за пределы куба выбрасывает исключение.
+        Область с нулевым количеством ячеек вдоль какой-либо оси задает
+        пустое представление.
+
+        @param cube   Куб типа Cube.
+        @param offset Координаты первой ячейки области в кубе.
+        @param extent Количество ячеек области вдоль осей X, Y, Z.
+        @param step   Шаг по ячейкам куба вдоль осей X, Y, Z.
+                      По умолчанию равен {1, 1, 1}.
+        @throw std::runtime_error
+    */
+    CubeView(
+        const Cube & cube,
+        const std::array<std::uint64_t, 3> & offset,
+        const std::array<std::uint64_t, 3> & extent,
+        const std::array<std::uint64_t, 3> & step
+    );
+
+    /**
+        Конструктор, создающий представление области куба с маской.
+
+        В случае выхода области за пределы куба или несовпадения размерностей
+        куба и маски выбрасывает исключение.
+
+        @param cube   Куб типа Cube.
+        @param mask   Маска типа Cube.
+        @param offset Координаты первой ячейки области в кубе.
+        @param extent Количество ячеек области вдоль осей X, Y, Z.
+        @param step   Шаг по ячейкам куба вдоль осей X, Y, Z.
+                      По умолчанию равен {1, 1, 1}.
+        @throw std::runtime_error
+    */
+    CubeView(
+        const Cube & cube,
+        const Cube & mask,
+        const std::array<std::uint64_t, 3> & offset,
+        const std::array<std::uint64_t, 3> & extent,
+        const std::array<std::uint64_t, 3> & step
+    );
+
+    /**
+        Возвращает индекс ячейки в представлении.
+
+        В случае невозможной координаты выбрасывает искючение.
+
+        @param i Координата вдоль оси X типа std::uint64_t.
+        @param j Координата вдоль оси Y типа std::uint64_t.
+        @param k Координата вдоль оси Z типа std::uint64_t.
+        @return Индекс ячейки в представлении типа std::uint64_t.
+        @throw std::runtime_error
+    */
+    std::uint64_t get_idx(std::uint64_t i, std::uint64_t j, std::uint64_t k) const;
+
+    /**
+        Возвращает индекс ячейки исходного куба по индексу ячейки
+        в представлении.
+
+        В случае невозможного индекса выбрасывает искючение.
+
+        @param idx Индекс ячейки в представлении типа std::uint64_t.
+        @return Индекс ячейки в кубе типа std::uint64_t.
+        @throw std::runtime_error
+    */
+    std::uint64_t get_global_idx(std::uint64_t idx) const;
+
+    /**
+        Возвращает индекс ячейки в заданной нумерации по индексу ячейки
+        в представлении.
+
+        @param idx       Индекс ячейки в представлении типа std::uint64_t.
+        @param numbering Нумерация типа CellNumbering.
+        @return Индекс ячейки типа std::uint64_t.
+        @throw std::runtime_error
+    */
+    std::uint64_t get_idx(std::uint64_t idx, CellNumbering numbering) const;
+
+    /**
+        Возвращает индекс ячейки в заданной нумерации по координатам
+        в представлении.
+
+        В отличие от перевода индекса не требует деления.
+        В случае невозможной координаты выбрасывает искючение.
+
+        @param i         Координата вдоль оси X типа std::uint64_t.
+        @param j         Координата вдоль оси Y типа std::uint64_t.
+        @param k         Координата вдоль оси Z типа std::uint64_t.
+        @param numbering Нумерация типа CellNumbering.
+        @return Индекс ячейки типа std::uint64_t.
+        @throw std::runtime_error
+    */
+    std::uint64_t get_idx(std::uint64_t i, std::uint64_t j, std::uint64_t k,
+                          CellNumbering numbering) const;
+
+    /**
+        Возвращает разность индексов соседних ячеек представления вдоль
+        осей X, Y, Z в заданной нумерации.
+
+        @param numbering Нумерация типа CellNumbering.
+        @return Разности индексов в виде std::array<std::uint64_t, 3>.
+    */
+    std::array<std::uint64_t, 3> get_strides(CellNumbering numbering) const;
+
+    /**
+        Возвращает значение ячейки в представлении по координатам.
+
+        В случае невозможной координаты выбрасывает искючение.
+
+        @param i Координата вдоль оси X типа std::uint64_t.
+        @param j Координата вдоль оси Y типа std::uint64_t.
+        @param k Координата вдоль оси Z типа std::uint64_t.
+        @return Значение ячейки типа bool.
+        @throw std::runtime_error
+    */
+    bool get(std::uint64_t i, std::uint64_t j, std::uint64_t k) const;
+
+    /**
+        Возвращает значение ячейки в представлении по индексу.
+
+        В случае невозможного индекса выбрасывает искючение.
+
+        @param idx Индекс ячейки в представлении типа std::uint64_t.
+        @return Значение ячейки типа bool.
+        @throw std::runtime_error
+    */
+    bool get(std::uint64_t idx) const;
+
+    /**
+        Возвращает исходный куб представления.
+
+        @return Куб типа Cube.
+    */
+    const Cube & get_cube() const;
+
+    /**
+        Возвращает количества ячеек в представлении вдоль оси X.
+
+        @return Количество ячеек в представлении типа std::uint64_t.
+    */
+    std::uint64_t get_nx() const;
+
+    /**
+        Возвращает количества ячеек в представлении вдоль оси Y.
+
+        @return Количество ячеек в представлении типа std::uint64_t.
+    */
+    std::uint64_t get_ny() const;
+
+    /**
+        Возвращает количества ячеек в представлении вдоль оси Z.
+
+        @return Количество ячеек в представлении типа std::uint64_t.
+    */
+    std::uint64_t get_nz() const;
+
+private:
+
+    /**
+        Исходный куб.
+    */
+    const Cube * cube;
+
+    /**
+        Маска исходного куба, nullptr в случае ее отсутствия.
+    */
+    const Cube * mask;
+
+    /**
+        Индекс первой ячейки представления в исходном кубе.
+    */
+    std::uint64_t base;
+
+    /**
+        Количество ячеек в представлении вдоль осей X, Y, Z.
+    */
+    std::uint64_t nx, ny, nz;
+
+    /**
+        Расстояние между соседними ячейками представления вдоль
+        осей X, Y, Z в нумерации исходного куба.
+    */
+    std::uint64_t sx, sy, sz;
+};
+
+CubeView::CubeView(const Cube & cube)
+    : CubeView(
+        cube,
+        {{0, 0, 0}},
+        {{cube.get_nx(), cube.get_ny(), cube.get_nz()}},
+        {{1, 1, 1}}
+    ) {}
+
+CubeView::CubeView(const Cube & cube, const Cube & mask)
+    : CubeView(
+        cube,
+        mask,
+        {{0, 0, 0}},
+        {{cube.get_nx(), cube.get_ny(), cube.get_nz()}},
+        {{1, 1, 1}}
+    ) {}
+
+CubeView::CubeView(
+    const Cube & cube,
+    const std::array<std::uint64_t, 3> & offset,
+    const std::array<std::uint64_t, 3> & extent,
+    const std::array<std::uint64_t, 3> & step = {{1, 1, 1}}
+) : cube{&cube}, mask{nullptr},
+    nx{extent[0]}, ny{extent[1]}, nz{extent[2]} {
+    const std::array<std::uint64_t, 3> n {
+        {cube.get_nx(), cube.get_ny(), cube.get_nz()}
+    };
+    // Представление без ячеек (в том числе всего куба с нулевой
+    // размерностью) допустимо при любом смещении
+    const bool empty = nx == 0 || ny == 0 || nz == 0;
+    for (std::size_t d = 0; d < 3; ++d) {
+        if (step[d] == 0)
+            throw std::runtime_error{"illegal view step"};
+        if (!empty && (offset[d] >= n[d]
+            || extent[d] - 1 > (n[d] - 1 - offset[d]) / step[d]))
+            throw std::runtime_error{"illegal view extent"};
+    }
+
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    if (!empty && (nx > max / ny || nx * ny > max / nz))
+        throw std::runtime_error{"illegal view size"};
+
+    base = offset[0] + offset[1] * n[0] + offset[2] * n[0] * n[1];
+    sx = step[0];
+    sy = step[1] * n[0];
+    sz = step[2] * n[0] * n[1];
+}
+
+CubeView::CubeView(
+    const Cube & cube,
+    const Cube & mask,
+    const std::array<std::uint64_t, 3> & offset,
+    const std::array<std::uint64_t, 3> & extent,
+    const std::array<std::uint64_t, 3> & step = {{1, 1, 1}}
+) : CubeView(cube, offset, extent, step) {
+    if (mask.get_nx() != cube.get_nx() || mask.get_ny() != cube.get_ny()
+        || mask.get_nz() != cube.get_nz())
+        throw std::runtime_error{"illegal mask size"};
+    this->mask = &mask;
+}
+
+std::uint64_t CubeView::get_idx(
+    std::uint64_t i, std::uint64_t j, std::uint64_t k) const {
+    if (i >= nx) throw std::runtime_error{"illegal nx index"};
+    if (j >= ny) throw std::runtime_error{"illegal ny index"};
+    if (k >= nz) throw std::runtime_error{"illegal nz index"};
+    return i + j * nx + k * nx * ny;
+}
+
+std::uint64_t CubeView::get_global_idx(std::uint64_t idx) const {
+    if (idx >= nx * ny * nz)
+        throw std::runtime_error{"illegal size index"};
+
+    const std::uint64_t k {idx / (nx * ny)};
+    idx -= k * nx * ny;
+    const std::uint64_t j {idx / nx};
+    const std::uint64_t i {idx - j * nx};
+
+    return base + i * sx + j * sy + k * sz;
+}
+
+std::uint64_t CubeView::get_idx(
+    std::uint64_t idx, CellNumbering numbering) const {
+    if (numbering == CellNumbering::global)
+        return get_global_idx(idx);
+    if (idx >= nx * ny * nz)
+        throw std::runtime_error{"illegal size index"};
+    return idx;
+}
+
+std::uint64_t CubeView::get_idx(
+    std::uint64_t i, std::uint64_t j, std::uint64_t k,
+    CellNumbering numbering) const {
+    if (i >= nx) throw std::runtime_error{"illegal nx index"};
+    if (j >= ny) throw std::runtime_error{"illegal ny index"};
+    if (k >= nz) throw std::runtime_error{"illegal nz index"};
+    if (numbering == CellNumbering::global)
+        return base + i * sx + j * sy + k * sz;
+    return i + j * nx + k * nx * ny;
+}
+
+std::array<std::uint64_t, 3> CubeView::get_strides(
+    CellNumbering numbering) const {
+    if (numbering == CellNumbering::global)
+        return std::array<std::uint64_t, 3> { {sx, sy, sz} };
+    return std::array<std::uint64_t, 3> { {1, nx, nx * ny} };
+}
+
+bool CubeView::get(std::uint64_t i, std::uint64_t j, std::uint64_t k) const {
+    if (i >= nx) throw std::runtime_error{"illegal nx index"};
+    if (j >= ny) throw std::runtime_error{"illegal ny index"};
+    if (k >= nz) throw std::runtime_error{"illegal nz index"};
+    const std::uint64_t idx = base + i * sx + j * sy + k * sz;
+    return cube->get(idx) && (mask == nullptr || mask->get(idx));
+}
+
+bool CubeView::get(std::uint64_t idx) const {
+    const std::uint64_t global_idx = get_global_idx(idx);
+    return cube->get(global_idx) && (mask == nullptr || mask->get(global_idx));
+}
+
+const Cube & CubeView::get_cube() const {
+    return *cube;
+}
+
+std::uint64_t CubeView::get_nx() const {
+    return nx;
+}
+
+std::uint64_t CubeView::get_ny() const {
+    return ny;
+}
+
+std::uint64_t CubeView::get_nz() const {
+    return nz;
+}
+
+#endif // __CUBE_VIEW__
@@ -1,11 +1,14 @@
+#include <array>
 #include <chrono>
 #include <iostream>
 #include <map>
 #include <set>
 #include <vector>
 
+#include "component_filter.h"
 #include "connected_cells.h"
 #include "cube.h"
+#include "cube_view.h"
 #include "disjoint_set.h"
 
 void perform_with_dfs();
@@ -24,6 +27,24 @@ void perform_with_dfs();
 */
 void perform_with_disjoint_set();
 
+/**
+    Выводит таймер измерения времени удаления из куба размерности 400x250x100
+    связанных областей, состоящих из менее чем 10 ячеек.
+
+    Также фильтр применяется к кубу размерности 0x5x5.
+*/
+void perform_with_filter();
+
+/**
+    Выводит количество связанных областей и таймеры поиска для области
+    40x30x20 куба размерности 400x250x100 с маской в виде шара.
+
+    Поиск выполняется обходом в глубину и системой непересекающихся
+    множеств, индексы ячеек выводятся в нумерации исходного куба.
+    Также выводится количество областей в кубе размерности 0x5x5.
+*/
+void perform_with_view();
+
 /**
     Создает систему непересекающиеся множеств упорядочных индексов связанных ячеек.
 
@@ -33,14 +54,22 @@ void perform_with_disjoint_set();
     ячейками. Если ячейка связана с другой, то происходит объединение их в одно
     множество.
 
+    Время работы пропорционально количеству ячеек представления.
+
     @param disjoint_set DSU для индексов ячеек типа DisjointSet<std::uint64_t>.
-    @param cube         Куб типа Cube.
+    @param view         Представление куба (или весь куб) типа CubeView.
+    @param numbering    Нумерация индексов ячеек в DSU типа CellNumbering.
+                        По умолчанию CellNumbering::local.
     @see DisjointSet#make_set(), DisjointSet#union_sets()
 */
-void make_union_sets(DisjointSet<std::uint64_t> & disjoint_set, Cube & cube);
+void make_union_sets(DisjointSet<std::uint64_t> & disjoint_set,
+                     const CubeView & view,
+                     CellNumbering numbering = CellNumbering::local);
 
 int main() {
     perform_with_disjoint_set();
+    perform_with_filter();
+    perform_with_view();
 
     return 0;
 }
@@ -98,26 +127,100 @@ void perform_with_disjoint_set() {
     std::cout << " (sec.)" << std::endl;
 }
 
-void make_union_sets(DisjointSet<std::uint64_t> & disjoint_set, Cube & cube) {
-    const std::uint64_t nx = cube.get_nx();
-    const std::uint64_t ny = cube.get_ny();
-    const std::uint64_t nz = cube.get_nz();
+void perform_with_filter() {
+    using myclock_t = std::chrono::system_clock;
+    using duration_t = std::chrono::duration<double>;
+
+    Cube cube{};
+    ComponentFilter filter{10};
+
+    std::cout << "Start filter components" << std::endl;
+    std::chrono::time_point<myclock_t> start = myclock_t::now();
+
+    filter.apply(cube);
+
+    double time = duration_t(myclock_t::now() - start).count();
+    std::cout << "Stop filter components" << std::endl;
+    std::cout << "Time used: " << time << " (sec.)" << std::endl;
+
+    // Фильтрация куба с нулевой размерностью ничего не делает
+    Cube empty{0, 5, 5};
+    filter.apply(empty);
+}
+
+void perform_with_view() {
+    using myclock_t = std::chrono::system_clock;
+    using duration_t = std::chrono::duration<double>;
+
+    Cube cube{};
+    Cube mask{};
+
+    // Маска - шар радиуса 12 с центром в середине области
+    const std::array<std::uint64_t, 3> offset { {180, 110, 40} };
+    const std::array<std::uint64_t, 3> extent { {40, 30, 20} };
+    for (std::uint64_t k = 0; k < mask.get_nz(); ++k)
+        for (std::uint64_t j = 0; j < mask.get_ny(); ++j)
+            for (std::uint64_t i = 0; i < mask.get_nx(); ++i) {
+                double dx = double(i) - (offset[0] + extent[0] / 2);
+                double dy = double(j) - (offset[1] + extent[1] / 2);
+                double dz = double(k) - (offset[2] + extent[2] / 2);
+                mask.set(i, j, k, dx * dx + dy * dy + dz * dz <= 12 * 12);
+            }
+
+    CubeView view{cube, mask, offset, extent};
+
+    std::chrono::time_point<myclock_t> start = myclock_t::now();
+    ConnectedCells connected_cells{view, CellNumbering::global};
+    double time1 = duration_t(myclock_t::now() - start).count();
+    std::cout << "DFS sets in view: " << connected_cells.size() << std::endl;
+    std::cout << "Time used: " << time1 << " (sec.)" << std::endl;
+
+    start = myclock_t::now();
+    DisjointSet<std::uint64_t> disjoint_set{};
+    make_union_sets(disjoint_set, view, CellNumbering::global);
+    std::size_t count = disjoint_set.get_leaders().size();
+    double time2 = duration_t(myclock_t::now() - start).count();
+    std::cout << "DSU sets in view: " << count << std::endl;
+    std::cout << "Time used: " << time2 << " (sec.)" << std::endl;
+
+    // Куб с нулевой размерностью задает пустое представление
+    Cube empty{0, 5, 5};
+    ConnectedCells empty_cells{empty};
+    DisjointSet<std::uint64_t> empty_set{};
+    make_union_sets(empty_set, empty);
+    std::cout << "Sets in empty cube: " << empty_cells.size() << ", ";
+    std::cout << empty_set.get_leaders().size() << std::endl;
+}
+
+void make_union_sets(DisjointSet<std::uint64_t> & disjoint_set,
+                     const CubeView & view,
+                     CellNumbering numbering) {
+    const std::uint64_t nx = view.get_nx();
+    const std::uint64_t ny = view.get_ny();
+    const std::uint64_t nz = view.get_nz();
+
+    // В DSU хранятся индексы в заданной нумерации, индексы соседних
+    // ячеек отличаются на соответствующий шаг
+    const std::array<std::uint64_t, 3> stride = view.get_strides(numbering);
+
+    if (nx == 0 || ny == 0 || nz == 0)
+        return;
 
     // Создание и объединение множеств индексов из плоскости XZ при j = 0
     for (std::uint64_t k = 0; k < nz; ++k)
         for (std::uint64_t i = 0; i < nx; ++i) {
-            std::uint64_t idx = i + k * nx * ny;
-            if (cube.get(idx)) {
+            std::uint64_t idx = view.get_idx(i, 0, k, numbering);
+            if (view.get(i, 0, k)) {
                 disjoint_set.make_set(idx);
 
                 if (i > 0) {
-                    std::uint64_t idx_left = idx - 1;
+                    std::uint64_t idx_left = idx - stride[0];
                     if (disjoint_set.count(idx_left))
                         disjoint_set.union_sets(idx, idx_left);
                 }
 
                 if (k > 0) {
-                    std::uint64_t idx_backward = idx - nx * ny; 
+                    std::uint64_t idx_backward = idx - stride[2]; 
                     if (disjoint_set.count(idx_backward))
                         disjoint_set.union_sets(idx, idx_backward);
                 }
@@ -127,17 +230,17 @@ void make_union_sets(DisjointSet<std::uint64_t> & disjoint_set, Cube & cube) {
     // Создание и объединение множеств индексов из плоскости XY при k = 0
     for (std::uint64_t j = 1; j < ny; ++j)
         for (std::uint64_t i = 0; i < nx; ++i) {
-            std::uint64_t idx = i + j * nx;
-            if (cube.get(idx)) {
+            std::uint64_t idx = view.get_idx(i, j, 0, numbering);
+            if (view.get(i, j, 0)) {
                 disjoint_set.make_set(idx);
 
                 if (i > 0) {
-                    std::uint64_t idx_left = idx - 1; 
+                    std::uint64_t idx_left = idx - stride[0]; 
                     if (disjoint_set.count(idx_left))
                         disjoint_set.union_sets(idx, idx_left);
                 }
 
-                std::uint64_t idx_up = idx - nx;
+                std::uint64_t idx_up = idx - stride[1];
                 if (disjoint_set.count(idx_up))
                     disjoint_set.union_sets(idx, idx_up);
             }
@@ -146,12 +249,12 @@ void make_union_sets(DisjointSet<std::uint64_t> & disjoint_set, Cube & cube) {
     // Создание и объединение множеств индексов из плоскости YZ при i = 0
     for (std::uint64_t k = 1; k < nz; ++k)
         for (std::uint64_t j = 1; j < ny; ++j) {
-            std::uint64_t idx = j * nx + k * nx * ny;
-            if (cube.get(idx)) {
+            std::uint64_t idx = view.get_idx(0, j, k, numbering);
+            if (view.get(0, j, k)) {
                 disjoint_set.make_set(idx);
 
-                std::uint64_t idx_up       = idx - nx;
-                std::uint64_t idx_backward = idx - nx * ny;
+                std::uint64_t idx_up       = idx - stride[1];
+                std::uint64_t idx_backward = idx - stride[2];
 
                 if (disjoint_set.count(idx_up))
                     disjoint_set.union_sets(idx, idx_up);
@@ -165,13 +268,13 @@ void make_union_sets(DisjointSet<std::uint64_t> & disjoint_set, Cube & cube) {
     for (std::uint64_t k = 1; k < nz; ++k)
         for (std::uint64_t j = 1; j < ny; ++j)
             for (std::uint64_t i = 1; i < nx; ++i) {
-                std::uint64_t idx = i + j * nx + k * nx * ny;
-                if (cube.get(idx)) {
+                std::uint64_t idx = view.get_idx(i, j, k, numbering);
+                if (view.get(i, j, k)) {
                     disjoint_set.make_set(idx);
 
-                    std::uint64_t idx_left     = idx - 1;
-                    std::uint64_t idx_up       = idx - nx;
-                    std::uint64_t idx_backward = idx - nx * ny;
+                    std::uint64_t idx_left     = idx - stride[0];
+                    std::uint64_t idx_up       = idx - stride[1];
+                    std::uint64_t idx_backward = idx - stride[2];
 
                     if (disjoint_set.count(idx_left))
                         disjoint_set.union_sets(idx, idx_left);